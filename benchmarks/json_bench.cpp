@@ -0,0 +1,204 @@
+#include "../src/aoi/aoijson.hpp"
+#include "../src/declarations/declarations.hpp"
+#ifndef AOI_BENCH_NO_POCO
+#include <Poco/Dynamic/Var.h>
+#include <Poco/JSON/Array.h>
+#include <Poco/JSON/Object.h>
+#include <Poco/JSON/Parser.h>
+#endif
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <variant>
+#include <vector>
+
+/// @brief a dependency free DOM, used as the full parse baseline when
+/// Poco::JSON is not available. Every string is copied, like the
+/// consumers of responseStream do today.
+struct domvalue {
+  std::variant<std::nullptr_t, bool, double, str, std::vector<domvalue>,
+               std::vector<std::pair<str, domvalue>>>
+      value;
+};
+
+/// @brief recursive descent parser building a domvalue tree.
+class domparser {
+private:
+  const char *p;
+  const char *end;
+
+  void skip_space() {
+    while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) {
+      p++;
+    }
+  }
+
+  str parse_string() {
+    str out;
+    for (p++; p < end && *p != '"'; p++) {
+      if (*p != '\\') {
+        out += *p;
+        continue;
+      }
+      switch (*++p) {
+      case 'n':
+        out += '\n';
+        break;
+      case 't':
+        out += '\t';
+        break;
+      case 'u':
+        out += '?';
+        p += 4;
+        break;
+      default:
+        out += *p;
+      }
+    }
+    p++;
+    return out;
+  }
+
+public:
+  domparser(const str &text) : p(text.data()), end(text.data() + text.size()) {}
+
+  domvalue parse() {
+    skip_space();
+    domvalue v;
+    if (*p == '{') {
+      std::vector<std::pair<str, domvalue>> members;
+      for (p++, skip_space(); *p != '}'; skip_space()) {
+        str key = parse_string();
+        skip_space();
+        p++;
+        members.emplace_back(std::move(key), parse());
+        skip_space();
+        if (*p == ',') {
+          p++;
+          skip_space();
+        }
+      }
+      p++;
+      v.value = std::move(members);
+    } else if (*p == '[') {
+      std::vector<domvalue> elements;
+      for (p++, skip_space(); *p != ']'; skip_space()) {
+        elements.push_back(parse());
+        skip_space();
+        if (*p == ',') {
+          p++;
+        }
+      }
+      p++;
+      v.value = std::move(elements);
+    } else if (*p == '"') {
+      v.value = parse_string();
+    } else if (*p == 't' || *p == 'f') {
+      v.value = *p == 't';
+      p += *p == 't' ? 4 : 5;
+    } else if (*p == 'n') {
+      p += 4;
+    } else {
+      char *after = nullptr;
+      v.value = std::strtod(p, &after);
+      p = after;
+    }
+    return v;
+  }
+};
+
+/// @brief builds an array of posts shaped like the ones returned by
+/// jsonplaceholder, with escapes and nested objects to skip.
+static str make_payload(lu32 posts) {
+  std::ostringstream oss;
+  oss << "[";
+  for (lu32 k = 0; k < posts; k++) {
+    oss << (k ? "," : "") << "\n  {\"userId\": " << k % 10 << ", \"id\": " << k
+        << ", \"title\": \"sunt aut facere \\\"repellat\\\" provident\","
+        << " \"body\": \"quia et suscipit\\nsuscipit recusandae consequuntur"
+        << " expedita et cum\\nreprehenderit molestiae ut ut quas totam\","
+        << " \"address\": {\"geo\": {\"lat\": \"-37.3159\", \"lng\": "
+           "\"81.1496\"}},"
+        << " \"tags\": [\"a\", \"b\", \"c\"], \"published\": true}";
+  }
+  oss << "\n]";
+  return oss.str();
+}
+
+/// @brief runs fn the given number of times and prints the throughput.
+template <typename F>
+static void bench(str name, const str &payload, lu32 runs, F fn) {
+  s64 checksum = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (lu32 k = 0; k < runs; k++) {
+    checksum += fn();
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  double mbs = (payload.size() * runs) / elapsed.count() / (1024 * 1024);
+  std::cout << std::left << std::setw(34) << name << std::right << std::fixed
+            << std::setprecision(1) << std::setw(10) << mbs << " MB/s"
+            << "  (checksum " << checksum << ")\n";
+}
+
+s32 main(void) {
+  for (lu32 posts : {100, 10000}) {
+    str payload = make_payload(posts);
+    lu32 runs = (64 * 1024 * 1024) / payload.size() + 1;
+    std::cout << "[BENCH] " << posts << " posts, " << payload.size()
+              << " bytes, " << runs << " runs\n";
+
+#ifndef AOI_BENCH_NO_POCO
+    bench("Poco::JSON::Parser full parse", payload, runs, [&]() {
+      Poco::JSON::Parser parser;
+      Poco::Dynamic::Var result = parser.parse(payload);
+      Poco::JSON::Array::Ptr array = result.extract<Poco::JSON::Array::Ptr>();
+      s64 sum = 0;
+      for (lu32 k = 0; k < array->size(); k++) {
+        sum += array->getObject(k)->getValue<s64>("id");
+      }
+      return sum;
+    });
+#endif
+
+    bench("domparser full parse", payload, runs, [&]() {
+      domvalue root = domparser(payload).parse();
+      s64 sum = 0;
+      for (const domvalue &post :
+           std::get<std::vector<domvalue>>(root.value)) {
+        for (const auto &member :
+             std::get<std::vector<std::pair<str, domvalue>>>(post.value)) {
+          if (member.first == "id") {
+            sum += static_cast<s64>(std::get<double>(member.second.value));
+          }
+        }
+      }
+      return sum;
+    });
+
+    bench("aoijson every id", payload, runs, [&]() {
+      s64 sum = 0;
+      for (aoijson post : aoijson(payload)) {
+        sum += post["id"].get_int().value_or(0);
+      }
+      return sum;
+    });
+
+    bench("aoijson single path", payload, runs, [&]() {
+      str path = std::to_string(posts - 1) + ".address.geo.lat";
+      return static_cast<s64>(aoijson(payload).at(path).raw().size());
+    });
+
+    bench("aoijson::each_element stream", payload, runs, [&]() {
+      std::istringstream stream(payload);
+      s64 sum = 0;
+      aoijson::each_element(stream, [&](aoijson post) {
+        sum += post["id"].get_int().value_or(0);
+      });
+      return sum;
+    });
+  }
+  return 0;
+}
@@ -55,6 +55,47 @@ private:
     }
   }
 
+  /// @brief Opens a session, sends the request and waits for the response.
+  /// Poco::Exception is not caught here, callers handle it.
+  /// @param url the url desired
+  /// @param builder the HTTP/Client configuration structure
+  /// @param session receives the session, it must outlive the returned stream
+  /// @param response receives the response status and headers
+  /// @return the stream holding the response body
+  static std::istream &
+  send_request(const str &url, const aoibuilder &builder,
+               std::unique_ptr<Poco::Net::HTTPClientSession> &session,
+               Poco::Net::HTTPResponse &response) {
+    Poco::URI uri(url);
+    if (builder.useSSL) {
+      session = std::make_unique<Poco::Net::HTTPSClientSession>(uri.getHost(),
+                                                                uri.getPort());
+    } else {
+      session = std::make_unique<Poco::Net::HTTPClientSession>(uri.getHost(),
+                                                               uri.getPort());
+    }
+
+    Poco::Net::HTTPRequest request(builder.METHOD, uri.getPathAndQuery(),
+                                   Poco::Net::HTTPMessage::HTTP_1_1);
+    request.set("Host", uri.getHost());
+    set_headers(request, builder.headers);
+    bool requestSend = false;
+    if (builder.METHOD == AOINET::_POST || builder.METHOD == AOINET::_PUT ||
+        builder.METHOD == AOINET::_PATCH) {
+      request.setContentLength(builder.body.length());
+      if (!builder.body.empty()) {
+        std::ostream &os = session->sendRequest(request);
+        os << builder.body;
+        requestSend = true;
+      }
+    }
+    if (!requestSend) {
+
+      session->sendRequest(request);
+    }
+    return session->receiveResponse(response);
+  }
+
 public:
   /// @brief checks the status code of the request.
   /// @param status unsigned integer that holds the http status code.
@@ -69,37 +110,9 @@ public:
                          aoibuilder builder = {AOINET::_GET, DEFAULT_HEADERS,
                                                "", true}) {
     try {
-      Poco::URI uri(url);
       std::unique_ptr<Poco::Net::HTTPClientSession> session;
-      if (builder.useSSL) {
-        session = std::make_unique<Poco::Net::HTTPSClientSession>(
-            uri.getHost(), uri.getPort());
-      } else {
-        session = std::make_unique<Poco::Net::HTTPClientSession>(uri.getHost(),
-                                                                 uri.getPort());
-      }
-
-      Poco::Net::HTTPRequest request(builder.METHOD, uri.getPathAndQuery(),
-                                     Poco::Net::HTTPMessage::HTTP_1_1);
-      request.set("Host", uri.getHost());
-      set_headers(request, builder.headers);
-      bool requestSend = false;
-      if (builder.METHOD == AOINET::_POST || builder.METHOD == AOINET::_PUT ||
-          builder.METHOD == AOINET::_PATCH) {
-        request.setContentLength(builder.body.length());
-        if (!builder.body.empty()) {
-          std::ostream &os = session->sendRequest(request);
-          os << builder.body;
-          requestSend = true;
-        }
-      }
-      if (!requestSend) {
-
-        session->sendRequest(request);
-      }
-      std::ostringstream oss;
       Poco::Net::HTTPResponse response;
-      std::istream &rs = session->receiveResponse(response);
+      std::istream &rs = send_request(url, builder, session, response);
       str responseText;
       Poco::StreamCopier::copyToString(rs, responseText);
       aoihttp r = {response, responseText};
@@ -112,6 +125,51 @@ public:
       return aoihttp{resp, {}};
     }
   }
+  /// @brief This method performs a blocking request and reads the
+  /// body as a top-level json array, one element at a time, instead
+  /// of copying it to the responseStream. Use it for large arrays.
+  /// @param url the url desired
+  /// @param builder the HTTP/Client configuration structure
+  /// @param callback called for each element, the aoijson is only valid
+  /// during the call.
+  /// @return returns an aoihttp structure with an empty responseStream.
+  /// If a 2xx body is truncated or not a json array the status is set to 0,
+  /// even though the callback may already have run for the first elements.
+  /// Other statuses are kept, so error bodies keep their http status.
+  static aoihttp perform_each(str url, aoibuilder builder,
+                              std::function<void(aoijson)> callback) {
+    try {
+      std::unique_ptr<Poco::Net::HTTPClientSession> session;
+      Poco::Net::HTTPResponse response;
+      std::istream &rs = send_request(url, builder, session, response);
+      if (!aoijson::each_element(rs, callback)) {
+        std::cerr << "Error in [perform_each]: body is not a complete json "
+                     "array"
+                  << "\n";
+        if (status_ok(response.getStatus())) {
+          response.setStatus("0");
+        }
+      }
+      return aoihttp{response, {}};
+
+    } catch (const Poco::Exception &e) {
+      std::cerr << "Exception: " << e.displayText() << '\n';
+      Poco::Net::HTTPResponse resp;
+      resp.setStatus("0");
+      return aoihttp{resp, {}};
+    }
+  }
+
+  /// @brief Same as perform_each with the default GET builder.
+  /// @param url the url desired
+  /// @param callback called for each element, the aoijson is only valid
+  /// during the call.
+  /// @return returns an aoihttp structure with an empty responseStream.
+  static aoihttp perform_each(str url, std::function<void(aoijson)> callback) {
+    return perform_each(url, {AOINET::_GET, DEFAULT_HEADERS, "", true},
+                        callback);
+  }
+
   /// @brief Performs an async / non-blocking request.
   /// @param url the desired url
   /// @param builder the HTTP/Client configuration structure
@@ -152,39 +210,10 @@ private:
   static void async_perform_engine(engine *worker) {
     aoidata *data = static_cast<aoidata *>(worker->data);
     try {
-
-      Poco::URI uri(data->url);
       std::unique_ptr<Poco::Net::HTTPClientSession> session;
-      if (data->builder.useSSL) {
-        session = std::make_unique<Poco::Net::HTTPSClientSession>(
-            uri.getHost(), uri.getPort());
-      } else {
-        session = std::make_unique<Poco::Net::HTTPClientSession>(uri.getHost(),
-                                                                 uri.getPort());
-      }
-
-      Poco::Net::HTTPRequest request(data->builder.METHOD,
-                                     uri.getPathAndQuery(),
-                                     Poco::Net::HTTPMessage::HTTP_1_1);
-      request.set("Host", uri.getHost());
-      aoi::set_headers(request, data->builder.headers);
-      bool requestSend = false;
-      if (data->builder.METHOD == AOINET::_POST ||
-          data->builder.METHOD == AOINET::_PUT ||
-          data->builder.METHOD == AOINET::_PATCH) {
-        request.setContentLength(data->builder.body.length());
-        if (!data->builder.body.empty()) {
-          std::ostream &os = session->sendRequest(request);
-          os << data->builder.body;
-          requestSend = true;
-        }
-      }
-      if (!requestSend) {
-
-        session->sendRequest(request);
-      }
       Poco::Net::HTTPResponse response;
-      std::istream &rs = session->receiveResponse(response);
+      std::istream &rs =
+          aoi::send_request(data->url, data->builder, session, response);
       str responseText;
       Poco::StreamCopier::copyToString(rs, responseText);
       data->response = {response, responseText};
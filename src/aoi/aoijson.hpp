@@ -0,0 +1,612 @@
+#ifndef AOIJSON_HPP
+#define AOIJSON_HPP
+
+#include "../declarations/declarations.hpp"
+#include <charconv>
+#include <functional>
+#include <istream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/// @brief the kind of a json value, deduced from its first byte.
+/// INVALID is returned for missing lookups and malformed input.
+enum class aoijsonkind { OBJECT, ARRAY, STRING, NUMBER, BOOL, NIL, INVALID };
+
+/// @brief A lazy, zero-copy view over a json document.
+/// Nothing is parsed up front: every lookup scans the underlying
+/// buffer on demand, skipping nested values with a SIMD scan for
+/// the structural characters. The view does not own the buffer,
+/// so it's only valid while the buffer (e.g. aoihttp::responseStream)
+/// is alive. The input is not validated, a malformed document
+/// only yields INVALID views where the scan fails.
+class aoijson {
+
+private:
+  /// @brief first byte of the value, nullptr for a missing value.
+  const char *cur = nullptr;
+  /// @brief end of the enclosing buffer, not of the value itself.
+  const char *limit = nullptr;
+  /// @brief the raw key of the value when it's an object member.
+  std::string_view name;
+
+  aoijson(const char *cur, const char *limit, std::string_view name = {})
+      : cur(cur), limit(limit), name(name) {}
+
+  /// @brief finds the first byte in [p, end) that is one of C...
+  /// 16 bytes are compared at once when SSE2 is available.
+  /// @return the position found, or end.
+  template <char... C>
+  static const char *scan(const char *p, const char *end) {
+#if defined(__SSE2__)
+    while (end - p >= 16) {
+      __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+      __m128i hits = _mm_setzero_si128();
+      ((hits = _mm_or_si128(hits, _mm_cmpeq_epi8(chunk, _mm_set1_epi8(C)))),
+       ...);
+      s32 mask = _mm_movemask_epi8(hits);
+      if (mask != 0) {
+        return p + __builtin_ctz(mask);
+      }
+      p += 16;
+    }
+#endif
+    for (; p < end; p++) {
+      if (((*p == C) || ...)) {
+        return p;
+      }
+    }
+    return end;
+  }
+
+  static bool is_space(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+  }
+
+  static const char *skip_space(const char *p, const char *end) {
+    while (p < end && is_space(*p)) {
+      p++;
+    }
+    return p;
+  }
+
+  /// @brief skips a string starting at its opening quote.
+  /// @return the position after the closing quote, nullptr if unterminated.
+  static const char *skip_string(const char *p, const char *end) {
+    p++;
+    while (true) {
+      p = scan<'"', '\\'>(p, end);
+      if (p == end) {
+        return nullptr;
+      }
+      if (*p == '"') {
+        return p + 1;
+      }
+      if (end - p < 2) {
+        return nullptr;
+      }
+      p += 2;
+    }
+  }
+
+  /// @brief skips an object or an array starting at its opening bracket.
+  /// @return the position after the closing bracket, nullptr if unbalanced.
+  static const char *skip_container(const char *p, const char *end) {
+    lu32 depth = 0;
+    while (true) {
+      p = scan<'"', '[', ']', '{', '}'>(p, end);
+      if (p == end) {
+        return nullptr;
+      }
+      if (*p == '"') {
+        p = skip_string(p, end);
+        if (!p) {
+          return nullptr;
+        }
+        continue;
+      }
+      if (*p == '[' || *p == '{') {
+        depth++;
+      } else if (--depth == 0) {
+        return p + 1;
+      }
+      p++;
+    }
+  }
+
+  /// @brief skips any value starting at its first byte.
+  /// @return the position after the value, nullptr if missing or malformed.
+  static const char *skip_value(const char *p, const char *end) {
+    if (!p || p >= end) {
+      return nullptr;
+    }
+    if (*p == '{' || *p == '[') {
+      return skip_container(p, end);
+    }
+    if (*p == '"') {
+      return skip_string(p, end);
+    }
+    const char *q = p;
+    while (q < end && *q != ',' && *q != ']' && *q != '}' && !is_space(*q)) {
+      q++;
+    }
+    return q == p ? nullptr : q;
+  }
+
+  /// @brief moves from the end of an entry to the start of the next one.
+  /// @return the next entry, nullptr at the closing bracket or on error.
+  static const char *next_entry(const char *p, const char *end) {
+    p = skip_space(p, end);
+    if (p == end || *p != ',') {
+      return nullptr;
+    }
+    p = skip_space(p + 1, end);
+    return p == end ? nullptr : p;
+  }
+
+  /// @brief reads the member starting at the key quote of p.
+  /// @return the member value, INVALID if malformed.
+  static aoijson read_member(const char *p, const char *end) {
+    if (*p != '"') {
+      return {};
+    }
+    const char *keyEnd = skip_string(p, end);
+    if (!keyEnd) {
+      return {};
+    }
+    const char *q = skip_space(keyEnd, end);
+    if (q == end || *q != ':') {
+      return {};
+    }
+    q = skip_space(q + 1, end);
+    if (q == end) {
+      return {};
+    }
+    return {q, end, std::string_view(p + 1, keyEnd - p - 2)};
+  }
+
+  static void append_utf8(str &out, u32 cp) {
+    if (cp < 0x80) {
+      out += static_cast<char>(cp);
+    } else if (cp < 0x800) {
+      out += static_cast<char>(0xC0 | (cp >> 6));
+      out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+      out += static_cast<char>(0xE0 | (cp >> 12));
+      out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+      out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+      out += static_cast<char>(0xF0 | (cp >> 18));
+      out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+      out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+      out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+  }
+
+  static std::optional<u32> read_hex4(std::string_view s, lu32 at) {
+    u32 cp = 0;
+    if (at + 4 > s.size() ||
+        std::from_chars(s.data() + at, s.data() + at + 4, cp, 16).ptr !=
+            s.data() + at + 4) {
+      return std::nullopt;
+    }
+    return cp;
+  }
+
+  /// @brief the raw text of a number, empty if the value is not a json
+  /// number, so tokens such as nan or -inf are never handed to from_chars.
+  std::string_view number_text() const {
+    if (kind() != aoijsonkind::NUMBER) {
+      return {};
+    }
+    std::string_view r = raw();
+    for (char c : r) {
+      if ((c < '0' || c > '9') && c != '-' && c != '+' && c != '.' &&
+          c != 'e' && c != 'E') {
+        return {};
+      }
+    }
+    return r;
+  }
+
+public:
+  /// @brief an INVALID view, returned by failed lookups.
+  aoijson() {}
+
+  /// @brief creates a view over a whole document.
+  /// @param document the json text, it must outlive the view.
+  explicit aoijson(std::string_view document)
+      : limit(document.data() + document.size()) {
+    const char *p = skip_space(document.data(), limit);
+    cur = p == limit ? nullptr : p;
+  }
+
+  /// @brief iterates over the elements of an array or the
+  /// values of an object, see aoijson::key() for the member names.
+  class iterator {
+  private:
+    const char *cur = nullptr;
+    const char *limit = nullptr;
+    std::string_view name;
+    bool object = false;
+
+    void load(const char *p) {
+      if (!p) {
+        cur = nullptr;
+        return;
+      }
+      aoijson v = object ? read_member(p, limit) : aoijson(p, limit);
+      cur = v.cur;
+      name = v.name;
+    }
+
+  public:
+    iterator() {}
+    iterator(const char *p, const char *limit, bool object)
+        : limit(limit), object(object) {
+      load(p);
+    }
+
+    aoijson operator*() const { return {cur, limit, name}; }
+    bool operator==(const iterator &other) const { return cur == other.cur; }
+    bool operator!=(const iterator &other) const { return !(*this == other); }
+
+    iterator &operator++() {
+      const char *after = skip_value(cur, limit);
+      load(after ? next_entry(after, limit) : nullptr);
+      return *this;
+    }
+  };
+
+  iterator begin() const {
+    aoijsonkind k = kind();
+    if (k != aoijsonkind::OBJECT && k != aoijsonkind::ARRAY) {
+      return {};
+    }
+    const char *p = skip_space(cur + 1, limit);
+    if (p == limit || *p == ']' || *p == '}') {
+      return {};
+    }
+    return {p, limit, k == aoijsonkind::OBJECT};
+  }
+
+  iterator end() const { return {}; }
+
+  /// @brief kind of the value, deduced from the first byte only.
+  aoijsonkind kind() const {
+    if (!cur) {
+      return aoijsonkind::INVALID;
+    }
+    switch (*cur) {
+    case '{':
+      return aoijsonkind::OBJECT;
+    case '[':
+      return aoijsonkind::ARRAY;
+    case '"':
+      return aoijsonkind::STRING;
+    case 't':
+    case 'f':
+      return aoijsonkind::BOOL;
+    case 'n':
+      return aoijsonkind::NIL;
+    default:
+      return (*cur == '-' || (*cur >= '0' && *cur <= '9'))
+                 ? aoijsonkind::NUMBER
+                 : aoijsonkind::INVALID;
+    }
+  }
+
+  /// @brief true if the view points to a value.
+  bool exists() const { return cur != nullptr; }
+  explicit operator bool() const { return exists(); }
+
+  /// @brief the raw key of the member, escapes are not decoded.
+  /// Empty for array elements and documents.
+  std::string_view key() const { return name; }
+
+  /// @brief the raw text of the value, empty if malformed.
+  std::string_view raw() const {
+    const char *after = skip_value(cur, limit);
+    return after ? std::string_view(cur, after - cur) : std::string_view();
+  }
+
+  /// @brief looks up a member of an object. Keys are compared
+  /// byte by byte against the raw (escaped) key.
+  /// @return the member or an INVALID view.
+  aoijson operator[](std::string_view key) const {
+    if (kind() != aoijsonkind::OBJECT) {
+      return {};
+    }
+    for (iterator it = begin(); it != end(); ++it) {
+      if ((*it).name == key) {
+        return *it;
+      }
+    }
+    return {};
+  }
+
+  /// @brief looks up an element of an array.
+  /// @return the element or an INVALID view.
+  aoijson operator[](lu32 index) const {
+    if (kind() != aoijsonkind::ARRAY) {
+      return {};
+    }
+    for (iterator it = begin(); it != end(); ++it) {
+      if (index-- == 0) {
+        return *it;
+      }
+    }
+    return {};
+  }
+
+  /// @brief follows a dotted path such as "address.geo.lat" or
+  /// "0.company.name", numeric segments index arrays.
+  /// @return the value or an INVALID view.
+  aoijson at(std::string_view path) const {
+    aoijson v = *this;
+    while (v.exists() && !path.empty()) {
+      lu32 dot = path.find('.');
+      std::string_view segment = path.substr(0, dot);
+      path = dot == std::string_view::npos ? std::string_view()
+                                           : path.substr(dot + 1);
+      lu32 index = 0;
+      auto [ptr, ec] = std::from_chars(
+          segment.data(), segment.data() + segment.size(), index);
+      if (v.kind() == aoijsonkind::ARRAY && ec == std::errc() &&
+          ptr == segment.data() + segment.size()) {
+        v = v[index];
+      } else {
+        v = v[segment];
+      }
+    }
+    return v;
+  }
+
+  /// @brief number of elements or members, counted by scanning.
+  lu32 size() const {
+    lu32 n = 0;
+    for (iterator it = begin(); it != end(); ++it) {
+      n++;
+    }
+    return n;
+  }
+
+  bool is_null() const { return raw() == "null"; }
+
+  std::optional<bool> get_bool() const {
+    std::string_view r = raw();
+    if (r == "true") {
+      return true;
+    }
+    if (r == "false") {
+      return false;
+    }
+    return std::nullopt;
+  }
+
+  /// @return std::nullopt if the value is not an integer or overflows s64.
+  std::optional<s64> get_int() const {
+    std::string_view r = number_text();
+    s64 v = 0;
+    if (r.empty()) {
+      return std::nullopt;
+    }
+    auto [ptr, ec] = std::from_chars(r.data(), r.data() + r.size(), v);
+    if (ec != std::errc() || ptr != r.data() + r.size()) {
+      return std::nullopt;
+    }
+    return v;
+  }
+
+  /// @return std::nullopt if the value is not a number or overflows double.
+  std::optional<double> get_double() const {
+    std::string_view r = number_text();
+    double v = 0;
+    if (r.empty()) {
+      return std::nullopt;
+    }
+    auto [ptr, ec] = std::from_chars(r.data(), r.data() + r.size(), v);
+    if (ec != std::errc() || ptr != r.data() + r.size()) {
+      return std::nullopt;
+    }
+    return v;
+  }
+
+  /// @brief the contents of a string without the quotes. This
+  /// does not copy, so escapes are not decoded, see get_unescaped.
+  std::optional<std::string_view> get_string() const {
+    if (kind() != aoijsonkind::STRING) {
+      return std::nullopt;
+    }
+    std::string_view r = raw();
+    if (r.empty()) {
+      return std::nullopt;
+    }
+    return r.substr(1, r.size() - 2);
+  }
+
+  /// @brief copies a string decoding its escapes to UTF-8.
+  /// @return std::nullopt if the value is not a string, or if it holds
+  /// an unknown escape or a surrogate \u escape that is not paired.
+  std::optional<str> get_unescaped() const {
+    std::optional<std::string_view> s = get_string();
+    if (!s) {
+      return std::nullopt;
+    }
+    str out;
+    out.reserve(s->size());
+    for (lu32 k = 0; k < s->size(); k++) {
+      char c = (*s)[k];
+      if (c != '\\') {
+        out += c;
+        continue;
+      }
+      c = (*s)[++k];
+      switch (c) {
+      case 'b':
+        out += '\b';
+        break;
+      case 'f':
+        out += '\f';
+        break;
+      case 'n':
+        out += '\n';
+        break;
+      case 'r':
+        out += '\r';
+        break;
+      case 't':
+        out += '\t';
+        break;
+      case 'u': {
+        std::optional<u32> cp = read_hex4(*s, k + 1);
+        if (!cp) {
+          return std::nullopt;
+        }
+        k += 4;
+        if (*cp >= 0xDC00 && *cp < 0xE000) {
+          return std::nullopt;
+        }
+        if (*cp >= 0xD800 && *cp < 0xDC00) {
+          if (k + 2 >= s->size() || (*s)[k + 1] != '\\' ||
+              (*s)[k + 2] != 'u') {
+            return std::nullopt;
+          }
+          std::optional<u32> low = read_hex4(*s, k + 3);
+          if (!low || *low < 0xDC00 || *low >= 0xE000) {
+            return std::nullopt;
+          }
+          *cp = 0x10000 + ((*cp - 0xD800) << 10) + (*low - 0xDC00);
+          k += 6;
+        }
+        append_utf8(out, *cp);
+        break;
+      }
+      case '"':
+      case '\\':
+      case '/':
+        out += c;
+        break;
+      default:
+        return std::nullopt;
+      }
+    }
+    return out;
+  }
+
+  /// @brief reads a top-level json array from a stream and calls
+  /// the callback for each element, keeping only the current element
+  /// in memory. Meant for large array bodies, see aoi::perform_each.
+  /// The view given to the callback is only valid during the call.
+  /// @param stream the stream holding the array, e.g. a response body.
+  /// @param callback called once per element.
+  /// @param chunkSize how many bytes are read from the stream at a time.
+  /// @return true if the whole array was read, false if malformed.
+  static bool each_element(std::istream &stream,
+                           std::function<void(aoijson)> callback,
+                           lu32 chunkSize = 1 << 16) {
+    std::vector<char> chunk(chunkSize);
+    str element;
+    lu32 depth = 0;
+    lu32 count = 0;
+    bool inString = false;
+    bool escaped = false;
+
+    // emits the buffered element, false if it's empty or not one value.
+    auto emit = [&]() {
+      aoijson v(element);
+      std::string_view r = v.raw();
+      const char *last = element.data() + element.size();
+      if (r.empty() || skip_space(r.data() + r.size(), last) != last) {
+        return false;
+      }
+      callback(v);
+      element.clear();
+      count++;
+      return true;
+    };
+
+    while (stream) {
+      stream.read(chunk.data(), chunk.size());
+      const char *p = chunk.data();
+      const char *last = p + stream.gcount();
+      const char *segment = p;
+      while (p < last) {
+        if (escaped) {
+          escaped = false;
+          p++;
+          continue;
+        }
+        if (inString) {
+          p = scan<'"', '\\'>(p, last);
+          if (p == last) {
+            break;
+          }
+          if (*p == '\\') {
+            escaped = true;
+          } else {
+            inString = false;
+          }
+          p++;
+          continue;
+        }
+        if (depth == 0) {
+          p = skip_space(p, last);
+          if (p == last) {
+            break;
+          }
+          if (*p != '[') {
+            return false;
+          }
+          depth = 1;
+          segment = ++p;
+          continue;
+        }
+        p = scan<'"', '[', ']', '{', '}', ','>(p, last);
+        if (p == last) {
+          break;
+        }
+        switch (*p) {
+        case '"':
+          inString = true;
+          break;
+        case '[':
+        case '{':
+          depth++;
+          break;
+        case ']':
+        case '}':
+          if (depth == 1) {
+            if (*p != ']') {
+              return false;
+            }
+            element.append(segment, p);
+            return emit() || (count == 0 && !aoijson(element).exists());
+          }
+          depth--;
+          break;
+        case ',':
+          if (depth == 1) {
+            element.append(segment, p);
+            if (!emit()) {
+              return false;
+            }
+            segment = p + 1;
+          }
+          break;
+        }
+        p++;
+      }
+      if (depth > 0) {
+        element.append(segment, last);
+      }
+    }
+    return false;
+  }
+};
+
+#endif // !AOIJSON_HPP
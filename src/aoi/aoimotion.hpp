@@ -2,6 +2,7 @@
 #define AOIMOTION_HPP
 
 #include "../declarations/declarations.hpp"
+#include "aoijson.hpp"
 #include <Poco/Net/HTTPClientSession.h>
 #include <Poco/Net/HTTPRequest.h>
 #include <Poco/Net/HTTPResponse.h>
@@ -56,6 +57,12 @@ typedef struct {
   Poco::Net::HTTPResponse response;
   str responseStream;
   u16 get_status() { return response.getStatus(); }
+  /// @brief a lazy json view over the responseStream, nothing is
+  /// parsed or copied until a field is looked up. The view is only
+  /// valid while this aoihttp is alive, so it can't be taken from a
+  /// temporary such as aoi::perform(url).json().
+  aoijson json() & { return aoijson(responseStream); }
+  aoijson json() && = delete;
 
 } aoihttp;
 
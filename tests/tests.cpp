@@ -245,6 +245,95 @@ void _delete() {
   uv_loop_close(loop);
 }
 
+void assert_json(bool ok, str what) {
+
+  std::cout << "[JSON] ";
+  if (!ok) {
+    Logger::error("Unexpected json " + what + ". Test failed.");
+    throw std::runtime_error("Json view returned an unexpected value");
+  }
+  Logger::success("Json " + what + " ok.");
+}
+
+void json() {
+
+  str payload = R"( [{"id": 1, "title": "a \"b\"", "tags": ["x", "]"],
+                      "geo": {"lat": -37.5}, "ok": true, "none": null},
+                     {"id": 2, "title": "c", "tags": [], "geo": {}}] )";
+  aoijson doc(payload);
+  assert_json(doc.kind() == aoijsonkind::ARRAY && doc.size() == 2, "size");
+  assert_json(doc[1]["id"].get_int() == 2, "lookup");
+  assert_json(doc.at("0.geo.lat").get_double() == -37.5, "path");
+  assert_json(doc.at("0.title").get_unescaped() == "a \"b\"", "unescape");
+  str escapes = R"(["\u00e9\ud83d\ude00\/", "\ud800x", "\ude00", "\x"])";
+  aoijson strings(escapes);
+  assert_json(strings[0].get_unescaped() == "\xc3\xa9\xf0\x9f\x98\x80/" &&
+                  !strings[1].get_unescaped() && !strings[2].get_unescaped() &&
+                  !strings[3].get_unescaped(),
+              "invalid escapes");
+  assert_json(doc.at("0.tags.1").get_string() == "]", "nested string");
+  assert_json(doc.at("0.ok").get_bool() == true && doc.at("0.none").is_null(),
+              "literals");
+  assert_json(!doc.at("1.geo.lat").exists() && !doc[2].exists(), "missing");
+
+  str overflows = R"({"big": 18446744073709551616, "huge": 1e999})";
+  aoijson numbers(overflows);
+  assert_json(!numbers["big"].get_int() && !numbers["huge"].get_double(),
+              "overflow");
+  str tokens = R"([nan, -inf, "12", true])";
+  aoijson notNumbers(tokens);
+  assert_json(!notNumbers[0].get_double() && !notNumbers[1].get_double() &&
+                  !notNumbers[2].get_int() && !notNumbers[3].get_int(),
+              "non numbers");
+
+  str blank = "   ";
+  aoijson empty(blank);
+  assert_json(!empty.exists() && empty.raw().empty() && !empty.is_null() &&
+                  !empty.get_int() && !empty.get_double() &&
+                  !empty.get_bool() && empty.size() == 0,
+              "empty body");
+  Poco::Net::HTTPResponse resp;
+  resp.setStatus("0");
+  aoihttp failed = {resp, {}};
+  assert_json(!failed.json().exists() && !failed.json().get_int(),
+              "empty response");
+
+  std::istringstream stream(payload);
+  s64 sum = 0;
+  bool ok = aoijson::each_element(
+      stream, [&](aoijson e) { sum += e["id"].get_int().value_or(0); }, 7);
+  assert_json(ok && sum == 3, "stream");
+
+  std::istringstream truncated("[1,2,3");
+  std::istringstream unseparated("[1 2]");
+  std::istringstream mismatched("[1}");
+  lu32 seen = 0;
+  bool truncatedOk = aoijson::each_element(
+      truncated, [&](aoijson e) { seen += e.exists(); });
+  bool unseparatedOk = aoijson::each_element(
+      unseparated, [&](aoijson e) { seen += e.exists(); });
+  bool mismatchedOk =
+      aoijson::each_element(mismatched, [&](aoijson e) { (void)e; });
+  assert_json(!truncatedOk && !unseparatedOk && !mismatchedOk && seen == 2,
+              "truncated stream");
+
+  /// SSL | Blocking
+  auto SSLBlocking =
+      aoi::perform(EXTERN_GET_URL, {AOINET::_GET, DEFAULT_HEADERS, "", true});
+  assert_status(SSLBlocking.get_status(), AOINET::_GET);
+  aoijson posts = SSLBlocking.json();
+  assert_json(posts.size() > 0 && posts[0]["title"].get_string().has_value(),
+              "response");
+
+  /// SSL | Streaming
+  lu32 elements = 0;
+  auto SSLStreaming = aoi::perform_each(
+      EXTERN_GET_URL, {AOINET::_GET, DEFAULT_HEADERS, "", true},
+      [&](aoijson post) { elements += post["id"].exists(); });
+  assert_status(SSLStreaming.get_status(), AOINET::_GET);
+  assert_json(elements == posts.size(), "streaming response");
+}
+
 s32 main(void) {
   std::cout << "[START] ";
   std::cout << "Initializing the tests.\n Performing all HTTP methods blocking "
@@ -255,6 +344,7 @@ s32 main(void) {
   patch();
   put();
   _delete();
+  json();
   std::cout << "[END] ";
   Logger::success("All tests passed successfully.");
 }